@@ -12,6 +12,8 @@ class OrderRequest(BaseModel):
     price: int
     quantity: int
     order_type: int = 0  # Default to GOOD_TILL_CANCEL
+    stop_price: int = 0  # Trigger price for STOP / STOP_LIMIT
+    account_id: int = 0  # Account for engine-side risk checks
 
 
 class CancelOrderRequest(BaseModel):
@@ -37,6 +39,14 @@ app = FastAPI(title="OrderBook API", version="1.0.0")
 # Global client - in production, use connection pooling
 orderbook_client = OrderBookClient()
 
+# The engine keeps at most an hour of 1s bars and a day of 1m bars
+MAX_STATS_BARS = 3600
+
+# Last snapshot per depth, revalidated against the engine's book version on each request.
+# Bounded like the engine's own cache: once this many depths are held it starts over.
+MAX_CACHED_DEPTHS = 16
+snapshot_cache: Dict[int, Dict[str, Any]] = {}
+
 
 @app.on_event("startup")
 async def startup_event():
@@ -76,7 +86,7 @@ async def add_order(order: OrderRequest):
         if order.side not in [0, 1]:
             raise HTTPException(status_code=400, detail="side must be 0 (BUY) or 1 (SELL)")
         
-        if order.order_type not in [0, 1, 2, 3, 4]:
+        if order.order_type not in [0, 1, 2, 3, 4, 5, 6]:
             raise HTTPException(status_code=400, detail="Invalid order_type")
         
         result = orderbook_client.add_order(
@@ -84,7 +94,9 @@ async def add_order(order: OrderRequest):
             side=Side(order.side),
             price=order.price,
             quantity=order.quantity,
-            order_type=OrderType(order.order_type)
+            order_type=OrderType(order.order_type),
+            stop_price=order.stop_price,
+            account_id=order.account_id
         )
         
         if not result.get("success", True):  # Some operations don't return success field
@@ -121,18 +133,30 @@ async def cancel_order(order_id: int):
 
 
 @app.get("/orderbook", response_model=OrderBookSnapshot)
-async def get_orderbook():
+async def get_orderbook(depth: int = 0):
     """Get the current order book state"""
     try:
-        orderbook = orderbook_client.get_orderbook()
+        cached = snapshot_cache.get(depth)
+        orderbook = orderbook_client.get_orderbook(
+            depth=depth,
+            if_newer_than=cached["version"] if cached else None,
+            epoch=cached["epoch"] if cached else None
+        )
         
         if not orderbook.get("success", False):
             raise HTTPException(status_code=500, detail="Failed to retrieve order book")
         
+        if orderbook.get("not_modified") and cached:
+            orderbook = cached
+        else:
+            if depth not in snapshot_cache and len(snapshot_cache) >= MAX_CACHED_DEPTHS:
+                snapshot_cache.clear()
+            snapshot_cache[depth] = orderbook
+        
         return OrderBookSnapshot(
             bids=orderbook.get("bids", []),
             asks=orderbook.get("asks", []),
-            total_orders=orderbook_client.get_orderbook_size()
+            total_orders=orderbook.get("total_orders", 0)
         )
         
     except Exception as e:
@@ -151,6 +175,28 @@ async def get_orderbook_size():
         raise HTTPException(status_code=500, detail=f"Internal error: {str(e)}")
 
 
+@app.get("/stats")
+async def get_trade_stats(interval: str = "1s", count: int = 60):
+    """Get engine-maintained trade statistics and OHLCV bars"""
+    try:
+        if interval not in ["1s", "1m"]:
+            raise HTTPException(status_code=400, detail="interval must be 1s or 1m")
+        if count < 1 or count > MAX_STATS_BARS:
+            raise HTTPException(status_code=400, detail=f"count must be between 1 and {MAX_STATS_BARS}")
+        
+        stats = orderbook_client.get_trade_stats(interval, count)
+        
+        if not stats.get("success", False):
+            raise HTTPException(status_code=500, detail=stats.get("error", "Failed to retrieve stats"))
+        
+        return stats
+        
+    except Exception as e:
+        if isinstance(e, HTTPException):
+            raise e
+        raise HTTPException(status_code=500, detail=f"Internal error: {str(e)}")
+
+
 # Convenience endpoints
 @app.post("/orders/buy")
 async def add_buy_order(order_id: int, price: int, quantity: int, order_type: int = 0):
@@ -10,6 +10,8 @@ class OrderType(IntEnum):
     FILL_OR_KILL = 2
     MARKET = 3
     GOOD_FOR_DAY = 4
+    STOP = 5
+    STOP_LIMIT = 6
 
 
 class Side(IntEnum):
@@ -51,13 +53,20 @@ class OrderBookClient:
 
         # Send request
         request_json = json.dumps(request)
-        self.socket.send(request_json.encode())
-
-        # Receive response
-        response_data = self.socket.recv(4096)
-        response = json.loads(response_data.decode())
-
-        return response
+        self.socket.sendall(request_json.encode())
+
+        # Receive response. Replies are not framed and snapshots or bar series can span
+        # many reads, so keep reading until the buffer holds one complete JSON document.
+        response_data = b""
+        while True:
+            chunk = self.socket.recv(65536)
+            if not chunk:
+                raise Exception("Connection closed by server")
+            response_data += chunk
+            try:
+                return json.loads(response_data.decode())
+            except (json.JSONDecodeError, UnicodeDecodeError):
+                continue
 
     def add_order(
         self,
@@ -65,7 +74,9 @@ class OrderBookClient:
         side: Side,
         price: int,
         quantity: int,
-        order_type: OrderType = OrderType.GOOD_TILL_CANCEL
+        order_type: OrderType = OrderType.GOOD_TILL_CANCEL,
+        stop_price: int = 0,
+        account_id: int = 0
     ) -> Dict[str, Any]:
         """Add an order to the order book"""
         data = {
@@ -73,24 +84,78 @@ class OrderBookClient:
             "side": int(side),
             "price": price,
             "quantity": quantity,
-            "orderType": int(order_type)
+            "orderType": int(order_type),
+            "stopPrice": stop_price,
+            "accountId": account_id
         }
         
         return self._send_request("add_order", data)
 
+    def modify_order(self, order_id: int, side: Side, price: int, quantity: int) -> Dict[str, Any]:
+        """Replace an order's side, price and quantity (loses time priority)"""
+        data = {
+            "orderId": order_id,
+            "side": int(side),
+            "price": price,
+            "quantity": quantity
+        }
+        
+        return self._send_request("modify_order", data)
+
     def cancel_order(self, order_id: int) -> Dict[str, Any]:
         """Cancel an order"""
         data = {"orderId": order_id}
         return self._send_request("cancel_order", data)
 
+    def set_risk_limits(
+        self,
+        account_id: int,
+        max_order_quantity: int = 0,
+        max_open_notional: int = 0,
+        max_position: int = 0,
+        price_band: int = 0
+    ) -> Dict[str, Any]:
+        """Configure pre-trade limits for an account (0 disables a limit)"""
+        data = {
+            "accountId": account_id,
+            "maxOrderQuantity": max_order_quantity,
+            "maxOpenNotional": max_open_notional,
+            "maxPosition": max_position,
+            "priceBand": price_band
+        }
+        
+        return self._send_request("set_risk_limits", data)
+
+    def get_account(self, account_id: int) -> Dict[str, Any]:
+        """Get an account's net position and open order notional"""
+        return self._send_request("get_account", {"accountId": account_id})
+
     def get_orderbook_size(self) -> int:
         """Get the number of orders in the book"""
         response = self._send_request("get_size")
         return response.get("size", 0)
 
-    def get_orderbook(self) -> Dict[str, Any]:
-        """Get the current order book state"""
-        return self._send_request("get_orderbook")
+    def get_orderbook(
+        self,
+        depth: int = 0,
+        if_newer_than: Optional[int] = None,
+        epoch: Optional[int] = None
+    ) -> Dict[str, Any]:
+        """Get the current order book state (depth 0 = all levels).
+
+        Passing the version and epoch of a previous snapshot returns
+        {"not_modified": True, ...} if the book has not changed since.
+        """
+        data: Dict[str, Any] = {"depth": depth}
+        if if_newer_than is not None:
+            data["ifNewerThan"] = if_newer_than
+            data["epoch"] = epoch or 0
+        return self._send_request("get_orderbook", data)
+
+    def get_trade_stats(self, interval: str = "1s", count: int = 60) -> Dict[str, Any]:
+        """Get last price, VWAP, volume and recent OHLCV bars ("1s" or "1m")"""
+        data = {"interval": interval, "count": count}
+        return self._send_request("get_trade_stats", data)
 
     def print_orderbook(self):
         """Print a formatted view of the order book"""
@@ -51,6 +51,255 @@ def test_direct_tcp_client():
         client.disconnect()
 
 
+def require_empty_book(client):
+    """The order type smoke tests trade against their own orders, so they need an empty book"""
+    size = client.get_orderbook_size()
+    if size != 0:
+        print(f"❌ Expected an empty book, found {size} orders. Restart the TCP server first.")
+        return False
+    return True
+
+
+def test_stop_orders():
+    """A resting buy stop triggers on a trade at its stop price and sweeps the asks"""
+    print("\n🛑 Testing Stop Orders")
+    print("=" * 50)
+    
+    client = OrderBookClient()
+    
+    if not client.connect():
+        print("❌ Failed to connect to TCP server")
+        return False
+    
+    try:
+        if not require_empty_book(client):
+            return False
+        
+        print("📝 Resting asks: ID=101 @ 500 x5, ID=102 @ 501 x3")
+        client.add_order(101, Side.SELL, 500, 5)
+        client.add_order(102, Side.SELL, 501, 3)
+        
+        print("📝 Adding buy stop: ID=103, Stop=500, Qty=3")
+        result = client.add_order(103, Side.BUY, 0, 3, OrderType.STOP, stop_price=500)
+        if result.get("trades_count") != 0:
+            print(f"❌ Stop traded before triggering: {result}")
+            return False
+        
+        print("📝 Trading at 500: ID=104, Side=BUY, Price=500, Qty=5")
+        result = client.add_order(104, Side.BUY, 500, 5)
+        print(f"✅ Result: {result}")
+        
+        stop_trades = [t for t in result.get("trades", []) if t["bid_order_id"] == 103]
+        if len(stop_trades) != 1 or stop_trades[0]["price"] != 501 or stop_trades[0]["quantity"] != 3:
+            print("❌ Stop did not trigger and fill against ID=102")
+            return False
+        
+        if client.get_orderbook_size() != 0:
+            print("❌ Orders left in the book after the stop filled")
+            return False
+        
+        print("✅ Stop triggered and filled at 501")
+        return True
+        
+    except Exception as e:
+        print(f"❌ Error: {e}")
+        return False
+    finally:
+        client.disconnect()
+
+
+def test_fill_or_kill_and_market():
+    """An unfillable FOK leaves the book untouched; a market order sweeps and never rests"""
+    print("\n🎯 Testing Fill-or-Kill and Market Orders")
+    print("=" * 50)
+    
+    client = OrderBookClient()
+    
+    if not client.connect():
+        print("❌ Failed to connect to TCP server")
+        return False
+    
+    try:
+        if not require_empty_book(client):
+            return False
+        
+        print("📝 Resting asks: ID=201 @ 600 x4, ID=202 @ 601 x4")
+        client.add_order(201, Side.SELL, 600, 4)
+        client.add_order(202, Side.SELL, 601, 4)
+        before = client.get_orderbook()
+        
+        print("📝 Adding FOK buy: ID=203, Price=601, Qty=10 (only 8 available)")
+        result = client.add_order(203, Side.BUY, 601, 10, OrderType.FILL_OR_KILL)
+        print(f"✅ Result: {result}")
+        
+        after = client.get_orderbook()
+        if result.get("trades_count") != 0 or after["asks"] != before["asks"] or after["bids"] != before["bids"]:
+            print("❌ FOK changed the book")
+            return False
+        
+        print("📝 Adding market buy: ID=204, Qty=10")
+        result = client.add_order(204, Side.BUY, 0, 10, OrderType.MARKET)
+        print(f"✅ Result: {result}")
+        
+        filled = sum(t["quantity"] for t in result.get("trades", []))
+        if filled != 8 or [(t["ask_order_id"], t["price"]) for t in result["trades"]] != [(201, 600), (202, 601)]:
+            print("❌ Market order did not sweep both levels")
+            return False
+        
+        if client.get_orderbook_size() != 0:
+            print("❌ Market order remainder was left in the book")
+            return False
+        
+        print("✅ FOK rejected whole, market order swept 8 and cancelled the rest")
+        return True
+        
+    except Exception as e:
+        print(f"❌ Error: {e}")
+        return False
+    finally:
+        client.disconnect()
+
+
+def test_trade_statistics():
+    """A trade moves last price, volume and the latest 1s bar"""
+    print("\n📈 Testing Trade Statistics")
+    print("=" * 50)
+    
+    client = OrderBookClient()
+    
+    if not client.connect():
+        print("❌ Failed to connect to TCP server")
+        return False
+    
+    try:
+        if not require_empty_book(client):
+            return False
+        
+        before = client.get_trade_stats("1s", 60)
+        
+        print("📝 Trading 6 at 650: ID=251 SELL, ID=252 BUY")
+        client.add_order(251, Side.SELL, 650, 6)
+        client.add_order(252, Side.BUY, 650, 6)
+        
+        after = client.get_trade_stats("1s", 60)
+        print(f"✅ Stats: last_price={after.get('last_price')} volume={after.get('volume')} bars={len(after.get('bars', []))}")
+        
+        if after.get("last_price") != 650 or after.get("volume") != before.get("volume", 0) + 6:
+            print("❌ Last price or volume did not reflect the trade")
+            return False
+        
+        if not after.get("bars") or after["bars"][-1]["close"] != 650:
+            print("❌ Latest 1s bar did not close at 650")
+            return False
+        
+        print("✅ Statistics updated from the trade")
+        return True
+        
+    except Exception as e:
+        print(f"❌ Error: {e}")
+        return False
+    finally:
+        client.disconnect()
+
+
+def test_risk_rejection():
+    """Orders over an account's limits come back with a reason and leave the book alone"""
+    print("\n🚦 Testing Pre-trade Risk")
+    print("=" * 50)
+    
+    client = OrderBookClient()
+    
+    if not client.connect():
+        print("❌ Failed to connect to TCP server")
+        return False
+    
+    try:
+        if not require_empty_book(client):
+            return False
+        
+        print("📝 Limiting account 7 to 10 per order")
+        client.set_risk_limits(7, max_order_quantity=10)
+        
+        print("📝 Adding buy over the limit: ID=301, Price=700, Qty=20, Account=7")
+        result = client.add_order(301, Side.BUY, 700, 20, account_id=7)
+        print(f"✅ Result: {result}")
+        if result.get("success") or result.get("reason") != 2 or result.get("reason_name") != "MaxOrderQuantity":
+            print("❌ Expected a MaxOrderQuantity rejection")
+            return False
+        
+        print("📝 Modifying a resting order over the limit: ID=302 x5 -> x20")
+        client.add_order(302, Side.BUY, 700, 5, account_id=7)
+        result = client.modify_order(302, Side.BUY, 700, 20)
+        print(f"✅ Result: {result}")
+        if result.get("reason") != 2 or client.get_orderbook_size() != 1:
+            print("❌ Rejected modify did not leave the original resting")
+            return False
+        
+        client.cancel_order(302)
+        print("✅ Rejections carried reason 2 (MaxOrderQuantity)")
+        return True
+        
+    except Exception as e:
+        print(f"❌ Error: {e}")
+        return False
+    finally:
+        client.disconnect()
+
+
+def test_snapshot_not_modified():
+    """ifNewerThan with the held version and epoch returns not_modified until the book changes"""
+    print("\n🗂️  Testing Snapshot Versioning")
+    print("=" * 50)
+    
+    client = OrderBookClient()
+    
+    if not client.connect():
+        print("❌ Failed to connect to TCP server")
+        return False
+    
+    try:
+        if not require_empty_book(client):
+            return False
+        
+        client.add_order(401, Side.BUY, 800, 5)
+        snapshot = client.get_orderbook()
+        version, epoch = snapshot["version"], snapshot["epoch"]
+        print(f"📝 Holding snapshot version={version} epoch={epoch}")
+        
+        result = client.get_orderbook(if_newer_than=version, epoch=epoch)
+        print(f"✅ Unchanged book: {result}")
+        if not result.get("not_modified"):
+            print("❌ Expected not_modified for an unchanged book")
+            return False
+        
+        print("📝 Adding and cancelling buy stop ID=402 (stops are not in the snapshot)")
+        client.add_order(402, Side.BUY, 0, 5, OrderType.STOP, stop_price=900)
+        client.cancel_order(402)
+        if not client.get_orderbook(if_newer_than=version, epoch=epoch).get("not_modified"):
+            print("❌ Stop orders invalidated the snapshot")
+            return False
+        
+        result = client.get_orderbook(if_newer_than=version, epoch=epoch + 1)
+        if result.get("not_modified") or len(result.get("bids", [])) != 1:
+            print("❌ A different epoch must get a full snapshot")
+            return False
+        
+        client.cancel_order(401)
+        result = client.get_orderbook(if_newer_than=version, epoch=epoch)
+        if result.get("not_modified") or result.get("version", 0) <= version:
+            print("❌ Expected a newer snapshot after a cancel")
+            return False
+        
+        print("✅ not_modified until the book changed")
+        return True
+        
+    except Exception as e:
+        print(f"❌ Error: {e}")
+        return False
+    finally:
+        client.disconnect()
+
+
 def test_fastapi_endpoints():
     """Test the FastAPI HTTP endpoints"""
     print("\n🌐 Testing FastAPI HTTP Endpoints")
@@ -117,6 +366,13 @@ def main():
     
     input("\nPress Enter when both servers are running...")
     
+    # Order type smoke tests need the freshly started, empty book
+    stop_success = test_stop_orders()
+    fok_success = test_fill_or_kill_and_market()
+    stats_success = test_trade_statistics()
+    risk_success = test_risk_rejection()
+    snapshot_success = test_snapshot_not_modified()
+    
     # Test direct TCP client
     tcp_success = test_direct_tcp_client()
     
@@ -126,10 +382,15 @@ def main():
     print("\n" + "=" * 60)
     print("📋 TEST SUMMARY")
     print("=" * 60)
+    print(f"Stop Orders:       {'✅ PASS' if stop_success else '❌ FAIL'}")
+    print(f"FOK / Market:      {'✅ PASS' if fok_success else '❌ FAIL'}")
+    print(f"Trade Statistics:  {'✅ PASS' if stats_success else '❌ FAIL'}")
+    print(f"Pre-trade Risk:    {'✅ PASS' if risk_success else '❌ FAIL'}")
+    print(f"Snapshot Versions: {'✅ PASS' if snapshot_success else '❌ FAIL'}")
     print(f"Direct TCP Client: {'✅ PASS' if tcp_success else '❌ FAIL'}")
     print(f"FastAPI HTTP API:  {'✅ PASS' if http_success else '❌ FAIL'}")
     
-    if tcp_success and http_success:
+    if all([stop_success, fok_success, stats_success, risk_success, snapshot_success, tcp_success, http_success]):
         print("\n🎉 All tests passed! Your OrderBook system is working!")
     else:
         print("\n😞 Some tests failed. Check the servers are running.")
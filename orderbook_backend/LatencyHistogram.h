@@ -0,0 +1,107 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+
+// Log-linear latency histogram: 16 sub-buckets per power of two, so any recorded value is
+// reported within ~6% while the whole range of int64 nanoseconds fits in a fixed array.
+class LatencyHistogram {
+    public:
+        LatencyHistogram(){
+            reset();
+        }
+
+        void record(std::int64_t value){
+            value = std::max<std::int64_t>(value, 0);
+            ++counts_[bucketIndex(value)];
+            ++count_;
+            sum_ += value;
+            min_ = std::min(min_, value);
+            max_ = std::max(max_, value);
+        }
+
+        void merge(const LatencyHistogram& other){
+            for (std::size_t i = 0; i < counts_.size(); ++i){
+                counts_[i] += other.counts_[i];
+            }
+            count_ += other.count_;
+            sum_ += other.sum_;
+            min_ = std::min(min_, other.min_);
+            max_ = std::max(max_, other.max_);
+        }
+
+        void reset(){
+            counts_.fill(0);
+            count_ = 0;
+            sum_ = 0;
+            min_ = std::numeric_limits<std::int64_t>::max();
+            max_ = 0;
+        }
+
+        // Upper bound of the bucket holding the given percentile (0-100).
+        std::int64_t percentile(double percent) const {
+            if (count_ == 0){
+                return 0;
+            }
+
+            std::uint64_t target = static_cast<std::uint64_t>(percent / 100.0 * count_);
+            target = std::clamp<std::uint64_t>(target, 1, count_);
+
+            std::uint64_t seen = 0;
+            for (std::size_t i = 0; i < counts_.size(); ++i){
+                seen += counts_[i];
+                if (seen >= target){
+                    return std::min(bucketUpperBound(i), max_);
+                }
+            }
+
+            return max_;
+        }
+
+        std::uint64_t getCount() const {
+            return count_;
+        }
+
+        std::int64_t getMin() const {
+            return count_ == 0 ? 0 : min_;
+        }
+
+        std::int64_t getMax() const {
+            return max_;
+        }
+
+        double getMean() const {
+            return count_ == 0 ? 0.0 : static_cast<double>(sum_) / count_;
+        }
+
+    private:
+        static constexpr int SubBucketBits = 4;
+        static constexpr std::int64_t SubBucketCount = 1 << SubBucketBits;
+
+        static std::size_t bucketIndex(std::int64_t value){
+            if (value < SubBucketCount){
+                return static_cast<std::size_t>(value);
+            }
+
+            int exponent = 63 - __builtin_clzll(static_cast<std::uint64_t>(value)) - SubBucketBits;
+            std::int64_t subBucket = (value >> exponent) - SubBucketCount;
+            return static_cast<std::size_t>(SubBucketCount + exponent * SubBucketCount + subBucket);
+        }
+
+        static std::int64_t bucketUpperBound(std::size_t index){
+            if (index < static_cast<std::size_t>(SubBucketCount)){
+                return static_cast<std::int64_t>(index);
+            }
+
+            std::int64_t exponent = (index - SubBucketCount) / SubBucketCount;
+            std::int64_t subBucket = (index - SubBucketCount) % SubBucketCount;
+            return ((SubBucketCount + subBucket + 1) << exponent) - 1;
+        }
+
+        std::array<std::uint64_t, SubBucketCount * 61> counts_;
+        std::uint64_t count_;
+        std::int64_t sum_;
+        std::int64_t min_;
+        std::int64_t max_;
+};
@@ -15,10 +15,17 @@ class Order {
             orderId_ = orderId;
             side_ = side;
             price_ = price;
+            stopPrice_ = Constants::InvalidPrice;
+            accountId_ = 0;
             initialQuantity_ = quantity;
             remainingQuantity_ = quantity;
         }
 
+        Order(OrderType orderType, OrderId orderId, Side side, Price price, Price stopPrice, Quantity quantity)
+            : Order(orderType, orderId, side, price, quantity) {
+            stopPrice_ = stopPrice;
+        }
+
         Order(OrderId orderId, Side side, Quantity quantity){
             Order(OrderType::Market, orderId, side, Constants::InvalidPrice, quantity);
         }
@@ -31,6 +38,14 @@ class Order {
             return orderType_;
         }
 
+        AccountId getAccountId() const {
+            return accountId_;
+        }
+
+        void setAccountId(AccountId accountId){
+            accountId_ = accountId;
+        }
+
         Side getSide() const {
             return side_;
         }
@@ -39,6 +54,14 @@ class Order {
             return price_;
         }
 
+        Price getStopPrice() const {
+            return stopPrice_;
+        }
+
+        bool isStopOrder() const {
+            return orderType_ == OrderType::Stop || orderType_ == OrderType::StopLimit;
+        }
+
         Quantity getInitialQuantity() const {
             return initialQuantity_;
         }
@@ -72,11 +95,33 @@ class Order {
             orderType_ = OrderType::GoodTillCancel;
         }
 
+        void ToFillAndKill(Price price){
+            if (getOrderType() != OrderType::Market){
+                throw std::runtime_error("Cannot convert non-market order");
+            }
+
+            price_ = price;
+            orderType_ = OrderType::FillAndKill;
+        }
+
+        // A triggered Stop becomes a Market order, a triggered StopLimit rests at its limit price.
+        void ActivateStop(){
+            if (getOrderType() == OrderType::Stop){
+                orderType_ = OrderType::Market;
+            } else if (getOrderType() == OrderType::StopLimit){
+                orderType_ = OrderType::GoodTillCancel;
+            } else {
+                throw std::runtime_error("Cannot activate non-stop order");
+            }
+        }
+
     private:
         OrderType orderType_;
         OrderId orderId_;
+        AccountId accountId_;
         Side side_;
         Price price_;
+        Price stopPrice_;
         Quantity initialQuantity_;
         Quantity remainingQuantity_;
 };
\ No newline at end of file
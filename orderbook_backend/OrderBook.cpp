@@ -18,9 +18,15 @@ bool OrderBook::canMatch(Side side, Price price) const {
     }
 }
 
-Trades OrderBook::MatchOrders() {
+// Only the order that was just inserted can cross the book, so every trade executes at the
+// price of the resting order on the other side. All trades from one call share a timestamp.
+Trades OrderBook::MatchOrders(Side aggressorSide) {
     Trades trades;
-    trades.reserve(orders_.size());
+    if (bids_.empty() || asks_.empty() || bids_.begin()->first < asks_.begin()->first){
+        return trades;
+    }
+
+    const Timestamp now = TradeStatistics::Now();
 
     while (true){
         if (bids_.empty() || asks_.empty()){
@@ -42,6 +48,11 @@ Trades OrderBook::MatchOrders() {
             bid->fill(quantity);
             ask->fill(quantity);
 
+            risk_.onFill(*bid, quantity);
+            risk_.onFill(*ask, quantity);
+            UpdateLevelData(Side::Buy, bid->getPrice(), quantity, bid->isFilled() ? LevelAction::Remove : LevelAction::Match);
+            UpdateLevelData(Side::Sell, ask->getPrice(), quantity, ask->isFilled() ? LevelAction::Remove : LevelAction::Match);
+
             if (bid->isFilled()){
                 bids.pop_front();
                 orders_.erase(bid->getOrderId());
@@ -52,9 +63,15 @@ Trades OrderBook::MatchOrders() {
                 orders_.erase(ask->getOrderId());
             }
 
+            Price tradePrice = aggressorSide == Side::Buy ? ask->getPrice() : bid->getPrice();
             trades.push_back(Trade{ 
                 TradeInfo{ bid->getOrderId(), bid->getPrice(), quantity }, 
-                TradeInfo{ ask->getOrderId(), ask->getPrice(), quantity }});
+                TradeInfo{ ask->getOrderId(), ask->getPrice(), quantity },
+                tradePrice });
+            lastTradePrice_ = tradePrice;
+            triggerHigh_ = std::max(triggerHigh_.value_or(tradePrice), tradePrice);
+            triggerLow_ = std::min(triggerLow_.value_or(tradePrice), tradePrice);
+            statistics_.onTrade(now, tradePrice, quantity);
         }
 
         if (bids.empty()){
@@ -66,53 +83,169 @@ Trades OrderBook::MatchOrders() {
         }
     }
 
-    if (!bids_.empty()){
-        auto& [_, bids] = *bids_.begin();
-        auto& order = bids.front();
-        if (order->getOrderType() == OrderType::FillAndKill){
-            CancelOrder(order->getOrderId());
+    return trades;
+}
+
+void OrderBook::UpdateLevelData(Side side, Price price, Quantity quantity, LevelAction action){
+    auto& levels = side == Side::Buy ? bidLevels_ : askLevels_;
+    auto& data = levels[price];
+
+    switch (action){
+        case LevelAction::Add:
+            data.count_ += 1;
+            data.quantity_ += quantity;
+            break;
+        case LevelAction::Remove:
+            data.count_ -= 1;
+            data.quantity_ -= quantity;
+            break;
+        case LevelAction::Match:
+            data.quantity_ -= quantity;
+            break;
+    }
+
+    if (data.count_ == 0){
+        levels.erase(price);
+    }
+}
+
+// Walks the opposite side best price first using only the level aggregates, stopping as soon
+// as the price limit is crossed or `target` is covered.
+Quantity OrderBook::GetAvailableQuantity(Side side, Price price, Quantity target) const {
+    Quantity available = 0;
+
+    if (side == Side::Buy){
+        for (const auto& [askPrice, _] : asks_){
+            if (askPrice > price || available >= target){
+                break;
+            }
+            available += askLevels_.at(askPrice).quantity_;
+        }
+    } else {
+        for (const auto& [bidPrice, _] : bids_){
+            if (bidPrice < price || available >= target){
+                break;
+            }
+            available += bidLevels_.at(bidPrice).quantity_;
         }
     }
 
-    if (!asks_.empty()){
-        auto& [_, asks] = *asks_.begin();
-        auto& order = asks.front();
-        if (order->getOrderType() == OrderType::FillAndKill){
-            CancelOrder(order->getOrderId());
+    return available;
+}
+
+// Worst opposite price a market order of `quantity` has to reach; the last level if the
+// book cannot cover it.
+Price OrderBook::GetSweepPrice(Side side, Quantity quantity) const {
+    Quantity available = 0;
+    Price sweepPrice = Constants::InvalidPrice;
+
+    if (side == Side::Buy){
+        for (const auto& [askPrice, _] : asks_){
+            sweepPrice = askPrice;
+            available += askLevels_.at(askPrice).quantity_;
+            if (available >= quantity){
+                break;
+            }
+        }
+    } else {
+        for (const auto& [bidPrice, _] : bids_){
+            sweepPrice = bidPrice;
+            available += bidLevels_.at(bidPrice).quantity_;
+            if (available >= quantity){
+                break;
+            }
         }
     }
 
-    return trades;
+    return sweepPrice;
 }
 
-Trades OrderBook::AddOrder(OrderPointer order){
-    if (orders_.find(order->getOrderId()) != orders_.end()){
+bool OrderBook::isStopTriggered(const OrderPointer& order) const {
+    if (!lastTradePrice_.has_value()){
+        return false;
+    }
+
+    if (order->getSide() == Side::Buy){
+        return *lastTradePrice_ >= order->getStopPrice();
+    } else {
+        return *lastTradePrice_ <= order->getStopPrice();
+    }
+}
+
+void OrderBook::Reserve(std::size_t orderCount, std::size_t levelCount){
+    orders_.reserve(orderCount);
+    stopOrders_.reserve(orderCount);
+    bidLevels_.reserve(levelCount);
+    askLevels_.reserve(levelCount);
+}
+
+bool OrderBook::hasOppositeLiquidity(Side side) const {
+    return side == Side::Buy ? !asks_.empty() : !bids_.empty();
+}
+
+RejectReason OrderBook::CheckRisk(const Order& order) const {
+    std::optional<Price> bestBid = bids_.empty() ? std::nullopt : std::optional<Price>{ bids_.begin()->first };
+    std::optional<Price> bestAsk = asks_.empty() ? std::nullopt : std::optional<Price>{ asks_.begin()->first };
+    return risk_.check(order, bestBid, bestAsk, order.getSide() == Side::Buy ? bestAsk : bestBid);
+}
+
+OrderResult OrderBook::AddOrder(OrderPointer order){
+    droppedStops_.clear();
+
+    if (orders_.find(order->getOrderId()) != orders_.end() ||
+        stopOrders_.find(order->getOrderId()) != stopOrders_.end()){
         return { };
     }
 
+    RejectReason reason = CheckRisk(*order);
+    if (reason != RejectReason::None){
+        return reason;
+    }
+
+    if (order->isStopOrder()){
+        if (!isStopTriggered(order)){
+            AddStopOrder(order);
+            return { };
+        }
+        order->ActivateStop();
+
+        if (order->getOrderType() == OrderType::Market && !hasOppositeLiquidity(order->getSide())){
+            droppedStops_.push_back(order->getOrderId());
+            return { };
+        }
+    }
+
+    Trades trades = InsertOrder(order);
+    ActivateStopOrders(trades);
+    return OrderResult{ std::move(trades) };
+}
+
+Trades OrderBook::InsertOrder(OrderPointer order){
     if (order->getOrderType() == OrderType::FillAndKill && !canMatch(order->getSide(), order->getPrice())){
         return { };
     }
 
+    if (order->getOrderType() == OrderType::FillOrKill &&
+        GetAvailableQuantity(order->getSide(), order->getPrice(), order->getRemainingQuantity()) < order->getRemainingQuantity()){
+        return { };
+    }
+
     OrderPointers::iterator iterator;
 
+    // Market orders sweep as many levels as they need and never rest.
     if (order->getOrderType() == OrderType::Market){
         if (order->getSide() == Side::Buy){
             if (asks_.empty()) {
                 throw std::runtime_error("Market Buy Order cannot be placed: No Ask orders available");
             }
-            auto [worst_ask, _] = *asks_.begin();
-            order->ToGoodTillCancel(worst_ask);
         } else {
             if (bids_.empty()) {
                 throw std::runtime_error("Market Sell Order cannot be placed: No Bid orders available");
             }
-            auto [worst_bid, _] = *bids_.begin();
-            order->ToGoodTillCancel(worst_bid);
         }
-    }     
+        order->ToFillAndKill(GetSweepPrice(order->getSide(), order->getRemainingQuantity()));
+    }
 
-    
 
     if (order->getSide() == Side::Buy){
         auto& orders = bids_[order->getPrice()];
@@ -126,17 +259,133 @@ Trades OrderBook::AddOrder(OrderPointer order){
     }
 
     orders_.insert({ order->getOrderId(), OrderEntry{ order, iterator } });
+    ++version_;
+    risk_.onOrderOpened(*order);
+    UpdateLevelData(order->getSide(), order->getPrice(), order->getRemainingQuantity(), LevelAction::Add);
+
+    Trades trades = MatchOrders(order->getSide());
+
+    if ((order->getOrderType() == OrderType::FillAndKill || order->getOrderType() == OrderType::FillOrKill) &&
+        orders_.find(order->getOrderId()) != orders_.end()){
+        CancelOrder(order->getOrderId());
+    }
 
-    return MatchOrders();
+    return trades;
+}
+
+void OrderBook::AddStopOrder(OrderPointer order){
+    OrderPointers::iterator iterator;
+
+    if (order->getSide() == Side::Buy){
+        auto& orders = buyStops_[order->getStopPrice()];
+        orders.push_back(order);
+        iterator = std::prev(orders.end());
+    } else {
+        auto& orders = sellStops_[order->getStopPrice()];
+        orders.push_back(order);
+        iterator = std::prev(orders.end());
+    }
+
+    stopOrders_.insert({ order->getOrderId(), OrderEntry{ order, iterator } });
+    risk_.onOrderOpened(*order);
+}
+
+void OrderBook::CancelStopOrder(OrderId orderId){
+    const auto [order, iterator] = stopOrders_.at(orderId);
+    stopOrders_.erase(orderId);
+    risk_.onOrderClosed(*order, order->getRemainingQuantity());
+
+    auto stopPrice = order->getStopPrice();
+    if (order->getSide() == Side::Buy){
+        auto& orders = buyStops_.at(stopPrice);
+        orders.erase(iterator);
+        if (orders.empty()){
+            buyStops_.erase(stopPrice);
+        }
+    } else {
+        auto& orders = sellStops_.at(stopPrice);
+        orders.erase(iterator);
+        if (orders.empty()){
+            sellStops_.erase(stopPrice);
+        }
+    }
+}
+
+// Removes every stop triggered by a trade since the last check with a single range scan per
+// side: buy stops up to the highest trade price, sell stops down to the lowest. Release order
+// is deterministic: buy stops by ascending stop price, then sell stops by descending stop
+// price, FIFO within each stop price level.
+OrderPointers OrderBook::TakeTriggeredStops(){
+    OrderPointers triggered;
+    if (!triggerHigh_.has_value()){
+        return triggered;
+    }
+
+    Price high = *triggerHigh_;
+    Price low = *triggerLow_;
+    triggerHigh_.reset();
+    triggerLow_.reset();
+
+    auto buyEnd = buyStops_.upper_bound(high);
+    for (auto it = buyStops_.begin(); it != buyEnd; ++it){
+        triggered.splice(triggered.end(), it->second);
+    }
+    buyStops_.erase(buyStops_.begin(), buyEnd);
+
+    auto sellEnd = sellStops_.upper_bound(low);
+    for (auto it = sellStops_.begin(); it != sellEnd; ++it){
+        triggered.splice(triggered.end(), it->second);
+    }
+    sellStops_.erase(sellStops_.begin(), sellEnd);
+
+    // Exposure is released here and re-opened at the real price when the order is inserted.
+    for (const auto& order : triggered){
+        stopOrders_.erase(order->getOrderId());
+        risk_.onOrderClosed(*order, order->getRemainingQuantity());
+    }
+
+    return triggered;
+}
+
+// Trades from activated stops can move the last trade price and trigger further stops,
+// so keep draining until the stop books are quiet.
+void OrderBook::ActivateStopOrders(Trades& trades){
+    while (true){
+        OrderPointers triggered = TakeTriggeredStops();
+        if (triggered.empty()){
+            break;
+        }
+
+        for (auto& order : triggered){
+            order->ActivateStop();
+
+            // A market stop with nothing to trade against is cancelled rather than rested.
+            if (order->getOrderType() == OrderType::Market && !hasOppositeLiquidity(order->getSide())){
+                droppedStops_.push_back(order->getOrderId());
+                continue;
+            }
+
+            Trades activated = InsertOrder(order);
+            trades.insert(trades.end(), activated.begin(), activated.end());
+        }
+    }
 }
 
 void OrderBook::CancelOrder(OrderId orderId){
+    if (stopOrders_.find(orderId) != stopOrders_.end()){
+        CancelStopOrder(orderId);
+        return;
+    }
+
     if (orders_.find(orderId) == orders_.end()){
         return;
     }
 
     const auto [order, iterator] = orders_.at(orderId);
     orders_.erase(orderId);
+    ++version_;
+    UpdateLevelData(order->getSide(), order->getPrice(), order->getRemainingQuantity(), LevelAction::Remove);
+    risk_.onOrderClosed(*order, order->getRemainingQuantity());
 
     if (order->getSide() == Side::Sell){
         auto price = order->getPrice();
@@ -155,35 +404,62 @@ void OrderBook::CancelOrder(OrderId orderId){
     }
 }
 
-Trades OrderBook::MatchOrder(OrderModify order){
-    if (orders_.find(order.getOrderId()) == orders_.end()){
+OrderResult OrderBook::MatchOrder(OrderModify order){
+    droppedStops_.clear();
+
+    OrderPointer existingOrder;
+    if (auto it = orders_.find(order.getOrderId()); it != orders_.end()){
+        existingOrder = it->second.order_;
+    } else if (auto it = stopOrders_.find(order.getOrderId()); it != stopOrders_.end()){
+        existingOrder = it->second.order_;
+    } else {
         return { };
     }
 
-    const auto& [existingOrder, _] = orders_.at(order.getOrderId());
+    OrderPointer replacement = order.toOrderPointer(existingOrder->getOrderType(), existingOrder->getStopPrice());
+    replacement->setAccountId(existingOrder->getAccountId());
+
+    // Check the replacement as if the original were gone, and leave the original in place if
+    // it is rejected.
+    risk_.onOrderClosed(*existingOrder, existingOrder->getRemainingQuantity());
+    RejectReason reason = CheckRisk(*replacement);
+    risk_.onOrderOpened(*existingOrder);
+    if (reason != RejectReason::None){
+        return reason;
+    }
+
     CancelOrder(order.getOrderId());
-    return AddOrder(order.toOrderPointer(existingOrder->getOrderType()));
+    return AddOrder(replacement);
 }
 
 std::size_t OrderBook::Size() const { return orders_.size(); }
 
-OrderBookLevelInfos OrderBook::getOrderInfos() const {
-    LevelInfos bidInfos, askInfos;
-    bidInfos.reserve(orders_.size());
-    askInfos.reserve(orders_.size());
+std::size_t OrderBook::StopOrderCount() const { return stopOrders_.size(); }
 
-    auto CreateLevelInfos = [](Price price, const OrderPointers& orders) {
-        return LevelInfo{ price, std::accumulate(orders.begin(), orders.end(), (Quantity)0, 
-        [](Quantity runningSum, const OrderPointer& order)
-        { return runningSum + order->getRemainingQuantity(); }) };
-    };
+const std::vector<OrderId>& OrderBook::getDroppedStops() const { return droppedStops_; }
+
+const TradeStatistics& OrderBook::getTradeStatistics() const { return statistics_; }
+
+void OrderBook::SetRiskLimits(AccountId accountId, const RiskLimits& limits){ risk_.setLimits(accountId, limits); }
+
+const RiskManager& OrderBook::getRiskManager() const { return risk_; }
+
+std::uint64_t OrderBook::getVersion() const { return version_; }
+
+OrderBookLevelInfos OrderBook::getOrderInfos(std::size_t depth) const {
+    std::size_t bidDepth = depth == 0 ? bids_.size() : std::min(depth, bids_.size());
+    std::size_t askDepth = depth == 0 ? asks_.size() : std::min(depth, asks_.size());
+
+    LevelInfos bidInfos, askInfos;
+    bidInfos.reserve(bidDepth);
+    askInfos.reserve(askDepth);
 
-    for (const auto& [price, orders] : bids_){
-        bidInfos.push_back(CreateLevelInfos(price, orders));
+    for (auto it = bids_.begin(); bidInfos.size() < bidDepth; ++it){
+        bidInfos.push_back(LevelInfo{ it->first, bidLevels_.at(it->first).quantity_ });
     }
 
-    for (const auto& [price, orders] : asks_){
-        askInfos.push_back(CreateLevelInfos(price, orders));
+    for (auto it = asks_.begin(); askInfos.size() < askDepth; ++it){
+        askInfos.push_back(LevelInfo{ it->first, askLevels_.at(it->first).quantity_ });
     }
 
     return OrderBookLevelInfos{ bidInfos, askInfos };
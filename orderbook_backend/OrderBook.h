@@ -8,6 +8,7 @@
 #include <string>
 #include <algorithm>
 #include <numeric>
+#include <optional>
 
 #include "Usings.h"
 #include "Order.h"
@@ -15,10 +16,18 @@
 #include "Trade.h"
 #include "OrderBookLevelInfos.h"
 #include "Side.h"
+#include "TradeStatistics.h"
+#include "RiskManager.h"
+#include "OrderResult.h"
 
 using BidsMap = std::map<Price, OrderPointers, std::greater<Price>>;
 using AsksMap = std::map<Price, OrderPointers, std::less<Price>>;
 
+// Stop books are keyed by stop price so that, for a given last trade price, every
+// triggered stop sits in the prefix [begin, upper_bound(lastTradePrice)).
+using BuyStopsMap = std::map<Price, OrderPointers, std::less<Price>>;
+using SellStopsMap = std::map<Price, OrderPointers, std::greater<Price>>;
+
 class OrderBook {
     private:
         struct OrderEntry {
@@ -26,18 +35,71 @@ class OrderBook {
             OrderPointers::iterator location_;
         };
 
+        // Per-level aggregates kept in step with bids_/asks_ so depth queries never touch orders.
+        struct LevelData {
+            Quantity quantity_{ };
+            Quantity count_{ };
+        };
+
+        enum class LevelAction {
+            Add,
+            Remove,
+            Match
+        };
+
         BidsMap bids_;
         AsksMap asks_;
         std::unordered_map<OrderId, OrderEntry> orders_;
+        std::unordered_map<Price, LevelData> bidLevels_;
+        std::unordered_map<Price, LevelData> askLevels_;
+
+        BuyStopsMap buyStops_;
+        SellStopsMap sellStops_;
+        std::unordered_map<OrderId, OrderEntry> stopOrders_;
+        std::optional<Price> lastTradePrice_;
+        // Range of trade prices since stops were last checked, so a sweep that passes through
+        // a stop price triggers it even if the final trade price is beyond it.
+        std::optional<Price> triggerHigh_;
+        std::optional<Price> triggerLow_;
+        std::vector<OrderId> droppedStops_;
+        TradeStatistics statistics_;
+        // Bumped whenever bids_ or asks_ change so readers can tell whether a snapshot is stale.
+        // Stops are not part of the snapshot, so adding or cancelling one leaves it alone.
+        std::uint64_t version_ = 0;
+        RiskManager risk_;
 
         bool canMatch(Side side, Price price) const;
-        Trades MatchOrders();
+        bool isStopTriggered(const OrderPointer& order) const;
+        void UpdateLevelData(Side side, Price price, Quantity quantity, LevelAction action);
+        Price GetSweepPrice(Side side, Quantity quantity) const;
+        Trades MatchOrders(Side aggressorSide);
+        Trades InsertOrder(OrderPointer order);
+        bool hasOppositeLiquidity(Side side) const;
+        RejectReason CheckRisk(const Order& order) const;
+        void AddStopOrder(OrderPointer order);
+        void CancelStopOrder(OrderId orderId);
+        OrderPointers TakeTriggeredStops();
+        void ActivateStopOrders(Trades& trades);
 
     public:
-        Trades AddOrder(OrderPointer order);
+        // Pre-sizes the order and level indexes so steady-state inserts do not rehash.
+        void Reserve(std::size_t orderCount, std::size_t levelCount);
+        // Orders failing the account's pre-trade risk checks come back rejected, book untouched.
+        OrderResult AddOrder(OrderPointer order);
         void CancelOrder(OrderId orderId);
-        Trades MatchOrder(OrderModify order);
+        // Quantity an order on `side` could execute at `price` or better, counted up to `target`.
+        Quantity GetAvailableQuantity(Side side, Price price, Quantity target) const;
+        OrderResult MatchOrder(OrderModify order);
         std::size_t Size() const;
-        OrderBookLevelInfos getOrderInfos() const;
+        std::size_t StopOrderCount() const;
+        // Market stops from the last AddOrder/MatchOrder call that triggered with nothing on the
+        // opposite side and were cancelled.
+        const std::vector<OrderId>& getDroppedStops() const;
+        std::uint64_t getVersion() const;
+        // Top `depth` levels per side; 0 returns every level.
+        OrderBookLevelInfos getOrderInfos(std::size_t depth = 0) const;
+        const TradeStatistics& getTradeStatistics() const;
+        void SetRiskLimits(AccountId accountId, const RiskLimits& limits);
+        const RiskManager& getRiskManager() const;
         void printOrderBook() const;
 };
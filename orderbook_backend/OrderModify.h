@@ -30,6 +30,10 @@ class OrderModify {
             return std::make_shared<Order>(type, getOrderId(), getSide(), getPrice(), getQuantity());
         }
 
+        OrderPointer toOrderPointer(OrderType type, Price stopPrice) const{
+            return std::make_shared<Order>(type, getOrderId(), getSide(), getPrice(), stopPrice, getQuantity());
+        }
+
     private:
         OrderId orderId_;
         Price price_;
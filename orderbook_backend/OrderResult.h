@@ -0,0 +1,34 @@
+#pragma once
+#include "Usings.h"
+#include "Trade.h"
+#include "RejectReason.h"
+
+// Outcome of AddOrder/MatchOrder. A risk rejection is an ordinary status, not an exception,
+// so the reject path costs no more than the check itself.
+class OrderResult {
+    public:
+        OrderResult(Trades trades = { }){
+            trades_ = std::move(trades);
+            rejectReason_ = RejectReason::None;
+        }
+
+        OrderResult(RejectReason rejectReason){
+            rejectReason_ = rejectReason;
+        }
+
+        const Trades& getTrades() const {
+            return trades_;
+        }
+
+        RejectReason getRejectReason() const {
+            return rejectReason_;
+        }
+
+        bool isRejected() const {
+            return rejectReason_ != RejectReason::None;
+        }
+
+    private:
+        Trades trades_;
+        RejectReason rejectReason_;
+};
@@ -5,5 +5,7 @@ enum class OrderType {
     FillAndKill,
     FillOrKill,
     Market,
-    GoodForDay
+    GoodForDay,
+    Stop,
+    StopLimit
 };
@@ -0,0 +1,24 @@
+#pragma once
+
+enum class RejectReason {
+    None,
+    UnknownAccount,
+    MaxOrderQuantity,
+    PriceBand,
+    MaxOpenNotional,
+    MaxPosition,
+    NoReferencePrice
+};
+
+inline const char* toString(RejectReason reason){
+    switch (reason){
+        case RejectReason::None: return "None";
+        case RejectReason::UnknownAccount: return "UnknownAccount";
+        case RejectReason::MaxOrderQuantity: return "MaxOrderQuantity";
+        case RejectReason::PriceBand: return "PriceBand";
+        case RejectReason::MaxOpenNotional: return "MaxOpenNotional";
+        case RejectReason::MaxPosition: return "MaxPosition";
+        case RejectReason::NoReferencePrice: return "NoReferencePrice";
+    }
+    return "Unknown";
+}
@@ -0,0 +1,134 @@
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include "Usings.h"
+#include "Order.h"
+#include "Side.h"
+#include "RejectReason.h"
+
+// A limit of 0 disables that check.
+struct RiskLimits {
+    Quantity maxOrderQuantity_;
+    std::int64_t maxOpenNotional_;
+    std::int64_t maxPosition_;
+    Price priceBand_;
+};
+
+// Per-account pre-trade state kept as flat arrays indexed by AccountId, so a check is a
+// handful of loads and compares. Accounts without configured limits are not restricted.
+class RiskManager {
+    public:
+        static constexpr std::size_t DefaultMaxAccounts = 4096;
+
+        explicit RiskManager(std::size_t maxAccounts = DefaultMaxAccounts)
+            : limits_(maxAccounts, RiskLimits{ }), hasLimits_(maxAccounts, 0), openNotional_(maxAccounts, 0),
+              openBuyQuantity_(maxAccounts, 0), openSellQuantity_(maxAccounts, 0), position_(maxAccounts, 0) { }
+
+        void setLimits(AccountId account, const RiskLimits& limits){
+            if (account >= limits_.size()){
+                throw std::runtime_error("Account id out of range");
+            }
+
+            limits_[account] = limits;
+            hasLimits_[account] = 1;
+        }
+
+        // `referencePrice` prices market orders for the notional check; the book passes the
+        // best opposite price, or nothing when that side is empty.
+        RejectReason check(const Order& order, std::optional<Price> bestBid, std::optional<Price> bestAsk,
+                           std::optional<Price> referencePrice) const {
+            AccountId account = order.getAccountId();
+            if (account >= limits_.size()){
+                return RejectReason::UnknownAccount;
+            }
+
+            if (!hasLimits_[account]){
+                return RejectReason::None;
+            }
+
+            const RiskLimits& limits = limits_[account];
+            Quantity quantity = order.getRemainingQuantity();
+            bool isMarket = order.getOrderType() == OrderType::Market;
+            if (isMarket && !referencePrice.has_value()){
+                return RejectReason::NoReferencePrice;
+            }
+            Price price = isMarket ? *referencePrice : exposurePrice(order);
+
+            if (limits.maxOrderQuantity_ != 0 && quantity > limits.maxOrderQuantity_){
+                return RejectReason::MaxOrderQuantity;
+            }
+
+            if (limits.priceBand_ != 0 && !isMarket && order.getOrderType() != OrderType::Stop){
+                if ((bestBid.has_value() && price < *bestBid - limits.priceBand_) ||
+                    (bestAsk.has_value() && price > *bestAsk + limits.priceBand_)){
+                    return RejectReason::PriceBand;
+                }
+            }
+
+            if (limits.maxOpenNotional_ != 0 &&
+                openNotional_[account] + static_cast<std::int64_t>(price) * quantity > limits.maxOpenNotional_){
+                return RejectReason::MaxOpenNotional;
+            }
+
+            // Worst case: every open order on the same side fills.
+            if (limits.maxPosition_ != 0){
+                std::int64_t worstPosition = order.getSide() == Side::Buy
+                    ? position_[account] + openBuyQuantity_[account] + quantity
+                    : -(position_[account] - openSellQuantity_[account] - quantity);
+                if (worstPosition > limits.maxPosition_){
+                    return RejectReason::MaxPosition;
+                }
+            }
+
+            return RejectReason::None;
+        }
+
+        // Resting stops count as open exposure until they trigger or are cancelled, so a pile of
+        // stops cannot add up to more than the account's limits.
+        void onOrderOpened(const Order& order){
+            updateOpen(order, order.getRemainingQuantity());
+        }
+
+        void onOrderClosed(const Order& order, Quantity quantity){
+            updateOpen(order, -quantity);
+        }
+
+        void onFill(const Order& order, Quantity quantity){
+            updateOpen(order, -quantity);
+            position_[order.getAccountId()] += order.getSide() == Side::Buy ? quantity : -quantity;
+        }
+
+        std::int64_t getPosition(AccountId account) const {
+            return position_.at(account);
+        }
+
+        std::int64_t getOpenNotional(AccountId account) const {
+            return openNotional_.at(account);
+        }
+
+    private:
+        // A resting Stop has no limit price, so its stop price stands in for it.
+        static Price exposurePrice(const Order& order){
+            return order.getOrderType() == OrderType::Stop ? order.getStopPrice() : order.getPrice();
+        }
+
+        void updateOpen(const Order& order, std::int64_t quantity){
+            AccountId account = order.getAccountId();
+            openNotional_[account] += static_cast<std::int64_t>(exposurePrice(order)) * quantity;
+            if (order.getSide() == Side::Buy){
+                openBuyQuantity_[account] += quantity;
+            } else {
+                openSellQuantity_[account] += quantity;
+            }
+        }
+
+        std::vector<RiskLimits> limits_;
+        std::vector<std::uint8_t> hasLimits_;
+        std::vector<std::int64_t> openNotional_;
+        std::vector<std::int64_t> openBuyQuantity_;
+        std::vector<std::int64_t> openSellQuantity_;
+        std::vector<std::int64_t> position_;
+};
@@ -0,0 +1,57 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Bounded single-producer/single-consumer ring. Capacity is rounded up to a power of two
+// and all slots are allocated up front, so push/pop never allocate or block.
+template <typename T>
+class SpscQueue {
+    public:
+        explicit SpscQueue(std::size_t capacity)
+            : slots_(roundUpToPowerOfTwo(capacity)), mask_(slots_.size() - 1) { }
+
+        SpscQueue(const SpscQueue&) = delete;
+        SpscQueue& operator=(const SpscQueue&) = delete;
+
+        bool tryPush(T&& value){
+            const std::size_t tail = tail_.load(std::memory_order_relaxed);
+            if (tail - head_.load(std::memory_order_acquire) == slots_.size()){
+                return false;
+            }
+
+            slots_[tail & mask_] = std::move(value);
+            tail_.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool tryPop(T& value){
+            const std::size_t head = head_.load(std::memory_order_relaxed);
+            if (head == tail_.load(std::memory_order_acquire)){
+                return false;
+            }
+
+            value = std::move(slots_[head & mask_]);
+            head_.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        std::size_t capacity() const {
+            return slots_.size();
+        }
+
+    private:
+        static std::size_t roundUpToPowerOfTwo(std::size_t value){
+            std::size_t result = 1;
+            while (result < value){
+                result <<= 1;
+            }
+            return result;
+        }
+
+        std::vector<T> slots_;
+        std::size_t mask_;
+        alignas(64) std::atomic<std::size_t> head_{ 0 };
+        alignas(64) std::atomic<std::size_t> tail_{ 0 };
+};
@@ -2,11 +2,14 @@
 #include <vector>
 #include "TradeInfo.h"
 
+// The bid and ask infos carry each order's own limit price; `price_` is what the trade
+// actually executed at, the price of the order that was resting.
 class Trade {
     public:
-        Trade(const TradeInfo& bidTrade, const TradeInfo& askTrade){
+        Trade(const TradeInfo& bidTrade, const TradeInfo& askTrade, Price price){
             bidTrade_ = bidTrade;
             askTrade_ = askTrade;
+            price_ = price;
         }
 
         const TradeInfo& getBidTrade() const {
@@ -17,7 +20,12 @@ class Trade {
             return askTrade_;
         }
 
+        Price getPrice() const {
+            return price_;
+        }
+
     private:
         TradeInfo bidTrade_;
         TradeInfo askTrade_;
+        Price price_;
 };
\ No newline at end of file
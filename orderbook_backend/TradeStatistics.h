@@ -0,0 +1,132 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+#include "Usings.h"
+
+// Milliseconds since the Unix epoch.
+using Timestamp = std::int64_t;
+
+struct Bar {
+    Timestamp startTime_;
+    Price open_;
+    Price high_;
+    Price low_;
+    Price close_;
+    std::int64_t volume_;
+};
+
+using Bars = std::vector<Bar>;
+
+// Fixed-capacity ring of OHLCV bars for one interval. Bars are only opened when a trade
+// lands in a new interval, so idle periods leave no empty bars behind.
+class BarSeries {
+    public:
+        BarSeries(Timestamp intervalMs, std::size_t capacity)
+            : intervalMs_(intervalMs), bars_(capacity) { }
+
+        void onTrade(Timestamp timestamp, Price price, Quantity quantity){
+            Timestamp startTime = timestamp - timestamp % intervalMs_;
+
+            if (size_ == 0 || bars_[head_].startTime_ != startTime){
+                head_ = size_ == 0 ? 0 : (head_ + 1) % bars_.size();
+                if (size_ < bars_.size()){
+                    ++size_;
+                }
+                bars_[head_] = Bar{ startTime, price, price, price, price, 0 };
+            }
+
+            Bar& bar = bars_[head_];
+            bar.high_ = std::max(bar.high_, price);
+            bar.low_ = std::min(bar.low_, price);
+            bar.close_ = price;
+            bar.volume_ += quantity;
+        }
+
+        Timestamp getInterval() const {
+            return intervalMs_;
+        }
+
+        std::size_t getSize() const {
+            return size_;
+        }
+
+        // Most recent `count` bars, oldest first.
+        Bars getBars(std::size_t count) const {
+            count = std::min(count, size_);
+            Bars bars;
+            bars.reserve(count);
+
+            std::size_t index = (head_ + bars_.size() - count + 1) % bars_.size();
+            for (std::size_t i = 0; i < count; ++i){
+                bars.push_back(bars_[index]);
+                index = (index + 1) % bars_.size();
+            }
+
+            return bars;
+        }
+
+    private:
+        Timestamp intervalMs_;
+        Bars bars_;
+        std::size_t head_ = 0;
+        std::size_t size_ = 0;
+};
+
+// Running statistics for one book, updated in O(1) for every trade MatchOrders produces.
+class TradeStatistics {
+    public:
+        static constexpr std::size_t SecondBarCapacity = 3600;
+        static constexpr std::size_t MinuteBarCapacity = 1440;
+
+        TradeStatistics()
+            : secondBars_(1000, SecondBarCapacity), minuteBars_(60 * 1000, MinuteBarCapacity) { }
+
+        static Timestamp Now(){
+            using namespace std::chrono;
+            return duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
+        }
+
+        void onTrade(Timestamp timestamp, Price price, Quantity quantity){
+            lastPrice_ = price;
+            volume_ += quantity;
+            notional_ += static_cast<std::int64_t>(price) * quantity;
+            ++tradeCount_;
+
+            secondBars_.onTrade(timestamp, price, quantity);
+            minuteBars_.onTrade(timestamp, price, quantity);
+        }
+
+        Price getLastPrice() const {
+            return lastPrice_;
+        }
+
+        std::int64_t getVolume() const {
+            return volume_;
+        }
+
+        std::uint64_t getTradeCount() const {
+            return tradeCount_;
+        }
+
+        double getVwap() const {
+            return volume_ == 0 ? 0.0 : static_cast<double>(notional_) / volume_;
+        }
+
+        const BarSeries& getSecondBars() const {
+            return secondBars_;
+        }
+
+        const BarSeries& getMinuteBars() const {
+            return minuteBars_;
+        }
+
+    private:
+        Price lastPrice_ = 0;
+        std::int64_t volume_ = 0;
+        std::int64_t notional_ = 0;
+        std::uint64_t tradeCount_ = 0;
+        BarSeries secondBars_;
+        BarSeries minuteBars_;
+};
@@ -6,6 +6,7 @@
 using Price = std::int32_t;
 using Quantity = std::int32_t;
 using OrderId = std::uint64_t;
+using AccountId = std::uint32_t;
 
 // Forward declarations
 class Order;
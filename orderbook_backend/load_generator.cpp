@@ -0,0 +1,520 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <vector>
+#include <array>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <cctype>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <unordered_map>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "Usings.h"
+#include "Side.h"
+#include "OrderType.h"
+#include "LatencyHistogram.h"
+
+using Clock = std::chrono::steady_clock;
+
+enum class Action {
+    Add,
+    Cancel,
+    Modify
+};
+
+constexpr std::size_t ActionCount = 3;
+const char* ActionNames[ActionCount] = { "add_order", "cancel_order", "modify_order" };
+
+enum class PriceDistribution {
+    Uniform,
+    Normal
+};
+
+// tcp_server only speaks JSON today; a binary encoder is added as another case in the
+// encode functions below so both can be replayed with the same workload.
+enum class Protocol {
+    Json
+};
+
+struct LoadConfig {
+    std::string host = "127.0.0.1";
+    int port = 9999;
+    int connections = 4;
+    double rate = 10'000;  // total requests/sec across all connections, open loop
+    int durationSec = 10;
+    double addWeight = 0.6;
+    double cancelWeight = 0.3;
+    double modifyWeight = 0.1;
+    Price midPrice = 100;
+    Price priceSpread = 10;
+    PriceDistribution priceDistribution = PriceDistribution::Uniform;
+    Quantity maxQuantity = 100;
+    std::uint32_t seed = 42;
+    Protocol protocol = Protocol::Json;
+};
+
+struct LiveOrder {
+    OrderId orderId;
+    Side side;
+    Quantity remaining;
+};
+
+// Orders this connection believes are resting, with an id index so fills reported in
+// responses can be applied without a scan. Removal swaps with the last element.
+class LiveOrders {
+    public:
+        bool empty() const {
+            return orders_.empty();
+        }
+
+        std::size_t size() const {
+            return orders_.size();
+        }
+
+        const LiveOrder& operator[](std::size_t index) const {
+            return orders_[index];
+        }
+
+        void add(const LiveOrder& order){
+            index_[order.orderId] = orders_.size();
+            orders_.push_back(order);
+        }
+
+        void removeAt(std::size_t index){
+            index_.erase(orders_[index].orderId);
+            if (index != orders_.size() - 1){
+                orders_[index] = orders_.back();
+                index_[orders_[index].orderId] = index;
+            }
+            orders_.pop_back();
+        }
+
+        // A modify replaces the order, so its remaining quantity starts over.
+        void reset(OrderId orderId, Quantity quantity){
+            auto it = index_.find(orderId);
+            if (it != index_.end()){
+                orders_[it->second].remaining = quantity;
+            }
+        }
+
+        // Ids from other connections are not in the index and are ignored.
+        void fill(OrderId orderId, Quantity quantity){
+            auto it = index_.find(orderId);
+            if (it == index_.end()){
+                return;
+            }
+
+            LiveOrder& order = orders_[it->second];
+            if (quantity >= order.remaining){
+                removeAt(it->second);
+            } else {
+                order.remaining -= quantity;
+            }
+        }
+
+    private:
+        std::vector<LiveOrder> orders_;
+        std::unordered_map<OrderId, std::size_t> index_;
+};
+
+// A resting order can be filled by another connection's aggressor, in which case the fill
+// only shows up in that connection's response. It is forwarded to the owner through here.
+struct FillInbox {
+    std::mutex mutex;
+    std::vector<std::pair<OrderId, Quantity>> fills;
+};
+
+struct ConnectionResult {
+    std::array<LatencyHistogram, ActionCount> latencies;
+    std::uint64_t errors = 0;
+    bool connected = false;
+};
+
+std::string encodeAdd(Protocol protocol, OrderId orderId, Side side, Price price, Quantity quantity) {
+    switch (protocol) {
+        case Protocol::Json:
+            return "{\"action\":\"add_order\",\"data\":{\"orderId\":" + std::to_string(orderId) +
+                   ",\"side\":" + std::to_string(static_cast<int>(side)) +
+                   ",\"price\":" + std::to_string(price) +
+                   ",\"quantity\":" + std::to_string(quantity) +
+                   ",\"orderType\":" + std::to_string(static_cast<int>(OrderType::GoodTillCancel)) + "}}";
+    }
+    return { };
+}
+
+std::string encodeCancel(Protocol protocol, OrderId orderId) {
+    switch (protocol) {
+        case Protocol::Json:
+            return "{\"action\":\"cancel_order\",\"data\":{\"orderId\":" + std::to_string(orderId) + "}}";
+    }
+    return { };
+}
+
+std::string encodeModify(Protocol protocol, OrderId orderId, Side side, Price price, Quantity quantity) {
+    switch (protocol) {
+        case Protocol::Json:
+            return "{\"action\":\"modify_order\",\"data\":{\"orderId\":" + std::to_string(orderId) +
+                   ",\"side\":" + std::to_string(static_cast<int>(side)) +
+                   ",\"price\":" + std::to_string(price) +
+                   ",\"quantity\":" + std::to_string(quantity) + "}}";
+    }
+    return { };
+}
+
+int connectToServer(const LoadConfig& config) {
+    addrinfo hints{};
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+
+    addrinfo* result = nullptr;
+    if (getaddrinfo(config.host.c_str(), std::to_string(config.port).c_str(), &hints, &result) != 0) {
+        return -1;
+    }
+
+    int sock = socket(result->ai_family, result->ai_socktype, result->ai_protocol);
+    if (sock >= 0 && connect(sock, result->ai_addr, result->ai_addrlen) != 0) {
+        close(sock);
+        sock = -1;
+    }
+    freeaddrinfo(result);
+
+    if (sock >= 0) {
+        int opt = 1;
+        setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &opt, sizeof(opt));
+    }
+    return sock;
+}
+
+// The server sends one JSON object per request without framing, so read until the
+// outermost braces balance.
+bool readResponse(int sock, std::string& response) {
+    char buffer[65536];
+    int depth = 0;
+    response.clear();
+
+    while (true) {
+        ssize_t bytes = recv(sock, buffer, sizeof(buffer), 0);
+        if (bytes <= 0) {
+            return false;
+        }
+
+        for (ssize_t i = 0; i < bytes; ++i) {
+            if (buffer[i] == '{') {
+                ++depth;
+            } else if (buffer[i] == '}') {
+                --depth;
+            }
+        }
+        response.append(buffer, bytes);
+
+        if (depth == 0 && !response.empty()) {
+            return true;
+        }
+    }
+}
+
+// Reads the unsigned integer stored under `key` in [begin, end) of a JSON response.
+bool findNumber(const std::string& json, std::size_t begin, std::size_t end, const char* key, std::uint64_t& value) {
+    std::string quotedKey = std::string("\"") + key + "\"";
+    std::size_t position = json.find(quotedKey, begin);
+    if (position == std::string::npos || position >= end) {
+        return false;
+    }
+
+    position += quotedKey.length();
+    while (position < end && (json[position] == ' ' || json[position] == ':')) {
+        ++position;
+    }
+
+    if (position >= end || !std::isdigit(static_cast<unsigned char>(json[position]))) {
+        return false;
+    }
+
+    value = std::strtoull(json.c_str() + position, nullptr, 10);
+    return true;
+}
+
+// Order ids are partitioned per connection so connections never collide.
+OrderId firstOrderId(int connectionIndex) {
+    return (static_cast<OrderId>(connectionIndex) + 1) << 40;
+}
+
+void applyFill(OrderId orderId, Quantity quantity, int connectionIndex, LiveOrders& liveOrders,
+               std::vector<FillInbox>& inboxes) {
+    std::uint64_t owner = (orderId >> 40) - 1;
+    if (owner == static_cast<std::uint64_t>(connectionIndex)) {
+        liveOrders.fill(orderId, quantity);
+    } else if (owner < inboxes.size()) {
+        std::lock_guard<std::mutex> lock(inboxes[owner].mutex);
+        inboxes[owner].fills.emplace_back(orderId, quantity);
+    }
+}
+
+// Applies the `trades` array of an add/modify response so fully filled orders are no
+// longer picked for cancels and modifies.
+void applyTrades(const std::string& response, int connectionIndex, LiveOrders& liveOrders,
+                 std::vector<FillInbox>& inboxes) {
+    std::size_t position = response.find("\"trades\"");
+    if (position == std::string::npos) {
+        return;
+    }
+
+    std::size_t arrayEnd = response.find(']', position);
+    if (arrayEnd == std::string::npos) {
+        return;
+    }
+
+    // Trade objects hold only scalar fields, so each one ends at the next closing brace.
+    while ((position = response.find('{', position)) < arrayEnd) {
+        std::size_t objectEnd = response.find('}', position);
+        std::uint64_t bidOrderId = 0;
+        std::uint64_t askOrderId = 0;
+        std::uint64_t quantity = 0;
+
+        if (findNumber(response, position, objectEnd, "quantity", quantity)) {
+            if (findNumber(response, position, objectEnd, "bid_order_id", bidOrderId)) {
+                applyFill(bidOrderId, static_cast<Quantity>(quantity), connectionIndex, liveOrders, inboxes);
+            }
+            if (findNumber(response, position, objectEnd, "ask_order_id", askOrderId)) {
+                applyFill(askOrderId, static_cast<Quantity>(quantity), connectionIndex, liveOrders, inboxes);
+            }
+        }
+
+        position = objectEnd;
+    }
+}
+
+bool sendRequest(int sock, const std::string& request) {
+    std::size_t sent = 0;
+    while (sent < request.length()) {
+        ssize_t bytes = send(sock, request.data() + sent, request.length() - sent, MSG_NOSIGNAL);
+        if (bytes <= 0) {
+            return false;
+        }
+        sent += bytes;
+    }
+    return true;
+}
+
+// Each connection replays its share of the target rate on a fixed schedule. Latency is
+// measured from the scheduled send time, so a slow response that delays later requests
+// shows up in their latency instead of quietly lowering the offered load.
+void runConnection(const LoadConfig& config, int connectionIndex, Clock::time_point start,
+                   std::vector<FillInbox>& inboxes, ConnectionResult& result) {
+    int sock = connectToServer(config);
+    if (sock < 0) {
+        return;
+    }
+    result.connected = true;
+
+    std::mt19937 rng(config.seed + connectionIndex);
+    std::discrete_distribution<int> actionDist({ config.addWeight, config.cancelWeight, config.modifyWeight });
+    std::uniform_int_distribution<int> uniformOffset(-config.priceSpread, config.priceSpread);
+    std::normal_distribution<double> normalOffset(0.0, config.priceSpread / 2.0);
+    std::uniform_int_distribution<Quantity> quantityDist(1, config.maxQuantity);
+    std::bernoulli_distribution sideDist(0.5);
+
+    auto nextPrice = [&]() {
+        int offset = config.priceDistribution == PriceDistribution::Uniform
+            ? uniformOffset(rng)
+            : static_cast<int>(std::lround(normalOffset(rng)));
+        return std::max<Price>(1, config.midPrice + offset);
+    };
+
+    OrderId nextOrderId = firstOrderId(connectionIndex);
+    LiveOrders liveOrders;
+    std::vector<std::pair<OrderId, Quantity>> forwardedFills;
+    std::string response;
+
+    auto interval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(config.connections / config.rate));
+    auto end = start + std::chrono::seconds(config.durationSec);
+    auto scheduled = start + interval * connectionIndex / config.connections;
+
+    while (scheduled < end) {
+        std::this_thread::sleep_until(scheduled);
+
+        {
+            std::lock_guard<std::mutex> lock(inboxes[connectionIndex].mutex);
+            forwardedFills.swap(inboxes[connectionIndex].fills);
+        }
+        for (const auto& [orderId, quantity] : forwardedFills) {
+            liveOrders.fill(orderId, quantity);
+        }
+        forwardedFills.clear();
+
+        auto action = static_cast<Action>(actionDist(rng));
+        if (liveOrders.empty()) {
+            action = Action::Add;
+        }
+
+        std::string request;
+        if (action == Action::Add) {
+            Side side = sideDist(rng) ? Side::Buy : Side::Sell;
+            OrderId orderId = nextOrderId++;
+            Quantity quantity = quantityDist(rng);
+            request = encodeAdd(config.protocol, orderId, side, nextPrice(), quantity);
+            liveOrders.add(LiveOrder{ orderId, side, quantity });
+        } else {
+            std::uniform_int_distribution<std::size_t> pick(0, liveOrders.size() - 1);
+            std::size_t index = pick(rng);
+            LiveOrder order = liveOrders[index];
+
+            if (action == Action::Cancel) {
+                request = encodeCancel(config.protocol, order.orderId);
+                liveOrders.removeAt(index);
+            } else {
+                Quantity quantity = quantityDist(rng);
+                request = encodeModify(config.protocol, order.orderId, order.side, nextPrice(), quantity);
+                liveOrders.reset(order.orderId, quantity);
+            }
+        }
+
+        if (!sendRequest(sock, request) || !readResponse(sock, response)) {
+            ++result.errors;
+            break;
+        }
+
+        auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - scheduled).count();
+        result.latencies[static_cast<std::size_t>(action)].record(latency);
+        if (response.find("\"error\"") != std::string::npos) {
+            ++result.errors;
+        } else if (action != Action::Cancel) {
+            applyTrades(response, connectionIndex, liveOrders, inboxes);
+        }
+
+        scheduled += interval;
+    }
+
+    close(sock);
+}
+
+void printReport(const LoadConfig& config, const std::vector<ConnectionResult>& results, double elapsedSec) {
+    std::array<LatencyHistogram, ActionCount> totals;
+    LatencyHistogram overall;
+    std::uint64_t errors = 0;
+    int connected = 0;
+
+    for (const auto& result : results) {
+        for (std::size_t i = 0; i < ActionCount; ++i) {
+            totals[i].merge(result.latencies[i]);
+            overall.merge(result.latencies[i]);
+        }
+        errors += result.errors;
+        connected += result.connected ? 1 : 0;
+    }
+
+    auto micros = [](std::int64_t ns) { return ns / 1000.0; };
+
+    std::cout << "\n=== LOAD GENERATOR REPORT ===" << std::endl;
+    std::cout << "Connections: " << connected << "/" << config.connections
+              << "  Target rate: " << config.rate << " req/s"
+              << "  Achieved: " << (overall.getCount() / elapsedSec) << " req/s"
+              << "  Errors: " << errors << std::endl;
+
+    std::cout << std::left << std::setw(14) << "ACTION" << std::right
+              << std::setw(10) << "COUNT" << std::setw(11) << "MEAN(us)" << std::setw(11) << "P50(us)"
+              << std::setw(11) << "P90(us)" << std::setw(11) << "P99(us)" << std::setw(12) << "P99.9(us)"
+              << std::setw(11) << "MAX(us)" << std::endl;
+    std::cout << std::string(91, '-') << std::endl;
+
+    auto printRow = [&](const std::string& name, const LatencyHistogram& histogram) {
+        std::cout << std::left << std::setw(14) << name << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(10) << histogram.getCount()
+                  << std::setw(11) << histogram.getMean() / 1000.0
+                  << std::setw(11) << micros(histogram.percentile(50))
+                  << std::setw(11) << micros(histogram.percentile(90))
+                  << std::setw(11) << micros(histogram.percentile(99))
+                  << std::setw(12) << micros(histogram.percentile(99.9))
+                  << std::setw(11) << micros(histogram.getMax()) << std::endl;
+    };
+
+    for (std::size_t i = 0; i < ActionCount; ++i) {
+        printRow(ActionNames[i], totals[i]);
+    }
+    printRow("all", overall);
+}
+
+void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [--host H] [--port N] [--connections N] [--rate REQ_PER_SEC]"
+              << " [--duration SECONDS] [--mix ADD,CANCEL,MODIFY] [--mid-price P] [--spread P]"
+              << " [--price-dist uniform|normal] [--max-quantity Q] [--seed S] [--protocol json]" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    LoadConfig config;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            printUsage(argv[0]);
+            return 1;
+        }
+        std::string value = argv[++i];
+
+        if (arg == "--host") {
+            config.host = value;
+        } else if (arg == "--port") {
+            config.port = std::stoi(value);
+        } else if (arg == "--connections") {
+            config.connections = std::stoi(value);
+        } else if (arg == "--rate") {
+            config.rate = std::stod(value);
+        } else if (arg == "--duration") {
+            config.durationSec = std::stoi(value);
+        } else if (arg == "--mix") {
+            if (std::sscanf(value.c_str(), "%lf,%lf,%lf", &config.addWeight, &config.cancelWeight, &config.modifyWeight) != 3) {
+                printUsage(argv[0]);
+                return 1;
+            }
+        } else if (arg == "--mid-price") {
+            config.midPrice = std::stoi(value);
+        } else if (arg == "--spread") {
+            config.priceSpread = std::stoi(value);
+        } else if (arg == "--price-dist" && (value == "uniform" || value == "normal")) {
+            config.priceDistribution = value == "uniform" ? PriceDistribution::Uniform : PriceDistribution::Normal;
+        } else if (arg == "--max-quantity") {
+            config.maxQuantity = std::stoi(value);
+        } else if (arg == "--seed") {
+            config.seed = static_cast<std::uint32_t>(std::stoul(value));
+        } else if (arg == "--protocol" && value == "json") {
+            config.protocol = Protocol::Json;
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (config.connections <= 0 || config.rate <= 0 || config.durationSec <= 0) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::cout << "Replaying " << config.rate << " req/s over " << config.connections << " connections to "
+              << config.host << ":" << config.port << " for " << config.durationSec << "s" << std::endl;
+
+    std::vector<ConnectionResult> results(config.connections);
+    std::vector<FillInbox> inboxes(config.connections);
+    std::vector<std::thread> threads;
+    auto start = Clock::now() + std::chrono::milliseconds(100);
+
+    for (int i = 0; i < config.connections; ++i) {
+        threads.emplace_back(runConnection, std::cref(config), i, start, std::ref(inboxes), std::ref(results[i]));
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    double elapsedSec = std::chrono::duration<double>(Clock::now() - start).count();
+    printReport(config, results, elapsedSec);
+
+    return 0;
+}
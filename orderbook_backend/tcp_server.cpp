@@ -1,24 +1,103 @@
 #include <iostream>
 #include <string>
 #include <thread>
+#include <atomic>
+#include <chrono>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <sys/socket.h>
+#include <sys/epoll.h>
+#include <sys/mman.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
 #include <unistd.h>
 #include <json/json.h>
 #include "OrderBook.h"
+#include "LatencyHistogram.h"
+#include "SpscQueue.h"
+
+using Clock = std::chrono::steady_clock;
+
+struct ServerConfig {
+    int port = 9999;
+    // Low-latency mode: one busy-polling network thread feeding one busy-polling matching
+    // thread over SPSC queues, optional CPU pinning, locked and prefaulted memory.
+    bool lowLatency = false;
+    int networkCpu = -1;
+    int matchingCpu = -1;
+    std::size_t prefaultOrders = 1'000'000;
+    std::size_t prefaultLevels = 16'384;
+    int reportIntervalSec = 10;
+};
+
+static bool pinCurrentThread(int cpu) {
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    CPU_SET(cpu, &cpuset);
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset) == 0;
+}
+
+static inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
 
 class OrderBookServer {
 private:
+    struct Request {
+        int client_socket;
+        std::uint64_t generation;
+        Clock::time_point received;
+        std::string payload;
+    };
+
+    struct Response {
+        int client_socket;
+        std::uint64_t generation;
+        std::string payload;
+    };
+
+    static constexpr std::size_t QueueCapacity = 4096;
+    static constexpr std::size_t MaxCachedDepths = 16;
+
+    struct CachedSnapshot {
+        std::uint64_t version_;
+        std::string encoded_;
+    };
+
     OrderBook orderbook_;
-    int server_fd_;
-    int port_;
+    ServerConfig config_;
+    int server_fd_ = -1;
+
+    // Default mode serialises client threads on the book; low-latency mode needs no lock
+    // because only the matching thread touches it.
+    std::mutex orderbookMutex_;
+    LatencyHistogram serviceLatency_;
+    std::unordered_map<std::size_t, CachedSnapshot> snapshotCache_;
+    // Identifies this server process so book versions from a previous run are never trusted.
+    const std::uint64_t epoch_ = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    Clock::time_point lastReport_ = Clock::now();
+
+    std::unique_ptr<SpscQueue<Request>> requests_;
+    std::unique_ptr<SpscQueue<Response>> responses_;
+    std::atomic<bool> running_{ true };
 
     std::string processRequest(const std::string& request) {
         Json::Value root;
         Json::Reader reader;
         Json::Value response;
         
-        if (!reader.parse(request, root)) {
+        if (!reader.parse(request, root) || !root.isObject()) {
             response["error"] = "Invalid JSON";
             return jsonToString(response);
         }
@@ -28,13 +107,21 @@ private:
         try {
             if (action == "add_order") {
                 return handleAddOrder(root["data"]);
+            } else if (action == "modify_order") {
+                return handleModifyOrder(root["data"]);
             } else if (action == "cancel_order") {
                 return handleCancelOrder(root["data"]);
             } else if (action == "get_size") {
                 response["size"] = static_cast<int>(orderbook_.Size());
                 response["success"] = true;
             } else if (action == "get_orderbook") {
-                return handleGetOrderBook();
+                return handleGetOrderBook(root["data"]);
+            } else if (action == "set_risk_limits") {
+                return handleSetRiskLimits(root["data"]);
+            } else if (action == "get_account") {
+                return handleGetAccount(root["data"]);
+            } else if (action == "get_trade_stats") {
+                return handleGetTradeStats(root["data"]);
             } else {
                 response["error"] = "Unknown action: " + action;
             }
@@ -54,25 +141,97 @@ private:
         OrderId orderId = data.get("orderId", 0).asUInt64();
         Side side = static_cast<Side>(data.get("side", 0).asInt());
         Price price = data.get("price", 0).asInt();
+        Price stopPrice = data.get("stopPrice", 0).asInt();
         Quantity quantity = data.get("quantity", 0).asInt();
         
-        auto order = std::make_shared<Order>(orderType, orderId, side, price, quantity);
-        Trades trades = orderbook_.AddOrder(order);
+        if ((orderType == OrderType::Stop || orderType == OrderType::StopLimit) && stopPrice <= 0) {
+            response["error"] = "Stop orders require a positive stopPrice";
+            response["success"] = false;
+            return jsonToString(response);
+        }
+        
+        auto order = std::make_shared<Order>(orderType, orderId, side, price, stopPrice, quantity);
+        order->setAccountId(data.get("accountId", 0).asUInt());
+        return orderResultToString(orderbook_.AddOrder(order));
+    }
+
+    std::string handleModifyOrder(const Json::Value& data) {
+        OrderId orderId = data.get("orderId", 0).asUInt64();
+        Side side = static_cast<Side>(data.get("side", 0).asInt());
+        Price price = data.get("price", 0).asInt();
+        Quantity quantity = data.get("quantity", 0).asInt();
+        
+        return orderResultToString(orderbook_.MatchOrder(OrderModify{ orderId, side, price, quantity }));
+    }
+
+    std::string orderResultToString(const OrderResult& result) {
+        Json::Value response;
+        
+        if (result.isRejected()) {
+            response["error"] = std::string("Order rejected: ") + toString(result.getRejectReason());
+            response["reason"] = static_cast<int>(result.getRejectReason());
+            response["reason_name"] = toString(result.getRejectReason());
+            response["success"] = false;
+            return jsonToString(response);
+        }
         
         response["success"] = true;
-        response["trades_count"] = static_cast<int>(trades.size());
+        response["trades_count"] = static_cast<int>(result.getTrades().size());
+        response["trades"] = tradesToJson(result.getTrades());
+        response["dropped_stops"] = droppedStopsToJson();
         
-        // Add trade details
+        return jsonToString(response);
+    }
+
+    // Market stops that triggered with an empty opposite side are cancelled, not rested.
+    Json::Value droppedStopsToJson() {
+        Json::Value droppedJson(Json::arrayValue);
+        for (OrderId orderId : orderbook_.getDroppedStops()) {
+            droppedJson.append(static_cast<Json::UInt64>(orderId));
+        }
+        return droppedJson;
+    }
+
+    Json::Value tradesToJson(const Trades& trades) {
         Json::Value tradesJson(Json::arrayValue);
         for (const auto& trade : trades) {
             Json::Value tradeJson;
             tradeJson["bid_order_id"] = static_cast<Json::UInt64>(trade.getBidTrade().orderId_);
             tradeJson["ask_order_id"] = static_cast<Json::UInt64>(trade.getAskTrade().orderId_);
-            tradeJson["price"] = trade.getBidTrade().price_;
+            tradeJson["price"] = trade.getPrice();
             tradeJson["quantity"] = trade.getBidTrade().quantity_;
             tradesJson.append(tradeJson);
         }
-        response["trades"] = tradesJson;
+        return tradesJson;
+    }
+
+    std::string handleSetRiskLimits(const Json::Value& data) {
+        Json::Value response;
+        
+        AccountId accountId = data.get("accountId", 0).asUInt();
+        RiskLimits limits{
+            data.get("maxOrderQuantity", 0).asInt(),
+            data.get("maxOpenNotional", 0).asInt64(),
+            data.get("maxPosition", 0).asInt64(),
+            data.get("priceBand", 0).asInt() };
+        orderbook_.SetRiskLimits(accountId, limits);
+        
+        response["success"] = true;
+        response["message"] = "Risk limits updated";
+        
+        return jsonToString(response);
+    }
+
+    std::string handleGetAccount(const Json::Value& data) {
+        Json::Value response;
+        
+        AccountId accountId = data.get("accountId", 0).asUInt();
+        const auto& risk = orderbook_.getRiskManager();
+        
+        response["account_id"] = accountId;
+        response["position"] = static_cast<Json::Int64>(risk.getPosition(accountId));
+        response["open_notional"] = static_cast<Json::Int64>(risk.getOpenNotional(accountId));
+        response["success"] = true;
         
         return jsonToString(response);
     }
@@ -89,10 +248,42 @@ private:
         return jsonToString(response);
     }
 
-    std::string handleGetOrderBook() {
+    // Snapshot reads are served from an encoded cache keyed by depth and tagged with the book
+    // version, so repeated polls of an unchanged book skip rebuilding and re-serialising it.
+    std::string handleGetOrderBook(const Json::Value& data) {
+        std::uint64_t version = orderbook_.getVersion();
+        std::size_t depth = data.get("depth", 0).asUInt();
+        
+        // Versions restart at 0 with the process, so a client's version only counts if it
+        // carries this process's epoch and matches exactly.
+        if (data.isMember("ifNewerThan") && data.get("epoch", 0).asUInt64() == epoch_ &&
+            data["ifNewerThan"].asUInt64() == version) {
+            Json::Value response;
+            response["not_modified"] = true;
+            response["version"] = static_cast<Json::UInt64>(version);
+            response["epoch"] = static_cast<Json::UInt64>(epoch_);
+            response["success"] = true;
+            return jsonToString(response);
+        }
+        
+        auto cached = snapshotCache_.find(depth);
+        if (cached != snapshotCache_.end() && cached->second.version_ == version) {
+            return cached->second.encoded_;
+        }
+        
+        if (snapshotCache_.size() >= MaxCachedDepths) {
+            snapshotCache_.clear();
+        }
+        
+        std::string encoded = encodeOrderBook(depth, version);
+        snapshotCache_[depth] = CachedSnapshot{ version, encoded };
+        return encoded;
+    }
+
+    std::string encodeOrderBook(std::size_t depth, std::uint64_t version) {
         Json::Value response;
         
-        auto orderBookInfo = orderbook_.getOrderInfos();
+        auto orderBookInfo = orderbook_.getOrderInfos(depth);
         
         // Add bids
         Json::Value bidsJson(Json::arrayValue);
@@ -114,6 +305,47 @@ private:
         
         response["bids"] = bidsJson;
         response["asks"] = asksJson;
+        response["total_orders"] = static_cast<Json::UInt64>(orderbook_.Size());
+        response["version"] = static_cast<Json::UInt64>(version);
+        response["epoch"] = static_cast<Json::UInt64>(epoch_);
+        response["success"] = true;
+        
+        return jsonToString(response);
+    }
+
+    std::string handleGetTradeStats(const Json::Value& data) {
+        Json::Value response;
+        
+        const auto& stats = orderbook_.getTradeStatistics();
+        std::string interval = data.get("interval", "1s").asString();
+        std::size_t count = data.get("count", 60).asUInt();
+        
+        if (interval != "1s" && interval != "1m") {
+            response["error"] = "Unknown interval: " + interval;
+            response["success"] = false;
+            return jsonToString(response);
+        }
+        
+        const BarSeries& series = interval == "1s" ? stats.getSecondBars() : stats.getMinuteBars();
+        
+        Json::Value barsJson(Json::arrayValue);
+        for (const auto& bar : series.getBars(count)) {
+            Json::Value barJson;
+            barJson["start_ms"] = static_cast<Json::Int64>(bar.startTime_);
+            barJson["open"] = bar.open_;
+            barJson["high"] = bar.high_;
+            barJson["low"] = bar.low_;
+            barJson["close"] = bar.close_;
+            barJson["volume"] = static_cast<Json::Int64>(bar.volume_);
+            barsJson.append(barJson);
+        }
+        
+        response["last_price"] = stats.getLastPrice();
+        response["vwap"] = stats.getVwap();
+        response["volume"] = static_cast<Json::Int64>(stats.getVolume());
+        response["trade_count"] = static_cast<Json::UInt64>(stats.getTradeCount());
+        response["interval"] = interval;
+        response["bars"] = barsJson;
         response["success"] = true;
         
         return jsonToString(response);
@@ -125,6 +357,27 @@ private:
         return Json::writeString(builder, json);
     }
 
+    // Service time is measured from the moment a request is read off the socket until its
+    // response is ready, so in low-latency mode it includes the queue hop to the matching thread.
+    void recordLatency(Clock::time_point received) {
+        auto now = Clock::now();
+        serviceLatency_.record(std::chrono::duration_cast<std::chrono::nanoseconds>(now - received).count());
+
+        if (now - lastReport_ < std::chrono::seconds(config_.reportIntervalSec)) {
+            return;
+        }
+
+        std::cout << "[" << (config_.lowLatency ? "low-latency" : "default") << "] requests=" << serviceLatency_.getCount()
+                  << " mean=" << static_cast<std::int64_t>(serviceLatency_.getMean()) << "ns"
+                  << " p50=" << serviceLatency_.percentile(50) << "ns"
+                  << " p99=" << serviceLatency_.percentile(99) << "ns"
+                  << " p99.9=" << serviceLatency_.percentile(99.9) << "ns"
+                  << " max=" << serviceLatency_.getMax() << "ns" << std::endl;
+
+        serviceLatency_.reset();
+        lastReport_ = now;
+    }
+
     void handleClient(int client_socket) {
         char buffer[4096];
         
@@ -136,8 +389,14 @@ private:
                 break;
             }
             
+            auto received = Clock::now();
             std::string request(buffer, bytes_read);
-            std::string response = processRequest(request);
+            std::string response;
+            {
+                std::lock_guard<std::mutex> lock(orderbookMutex_);
+                response = processRequest(request);
+                recordLatency(received);
+            }
             
             send(client_socket, response.c_str(), response.length(), 0);
         }
@@ -145,10 +404,209 @@ private:
         close(client_socket);
     }
 
+    void prepareLowLatency() {
+        if (std::thread::hardware_concurrency() < 3) {
+            std::cerr << "Warning: low-latency mode busy-polls two threads; with fewer than 3 CPUs they will "
+                      << "time-slice and latency will be worse than default mode" << std::endl;
+        }
+
+        if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+            std::cerr << "mlockall failed: " << strerror(errno) << " (continuing with pageable memory)" << std::endl;
+        }
+
+        // Allocating the indexes and queue slots now faults their pages in before the first order.
+        orderbook_.Reserve(config_.prefaultOrders, config_.prefaultLevels);
+        requests_ = std::make_unique<SpscQueue<Request>>(QueueCapacity);
+        responses_ = std::make_unique<SpscQueue<Response>>(QueueCapacity);
+    }
+
+    void runMatchingLoop() {
+        if (config_.matchingCpu >= 0 && !pinCurrentThread(config_.matchingCpu)) {
+            std::cerr << "Failed to pin matching thread to CPU " << config_.matchingCpu << std::endl;
+        }
+
+        Request request;
+        while (running_.load(std::memory_order_relaxed)) {
+            if (!requests_->tryPop(request)) {
+                cpuRelax();
+                continue;
+            }
+
+            Response response{ request.client_socket, request.generation, processRequest(request.payload) };
+            recordLatency(request.received);
+
+            while (!responses_->tryPush(std::move(response))) {
+                cpuRelax();
+            }
+        }
+    }
+
+    // Network-thread view of a client. Output the socket would not take yet waits in
+    // `pending_` and is flushed on EPOLLOUT, so a slow reader never stalls other clients.
+    struct Connection {
+        std::uint64_t generation_;
+        std::string pending_;
+        bool waitingForWritable_;
+    };
+
+    // A client that stops reading is dropped once this much output is queued for it.
+    static constexpr std::size_t MaxPendingBytes = 16 * 1024 * 1024;
+
+    static void closeConnection(int epoll_fd, std::unordered_map<int, Connection>& connections, int fd) {
+        epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+        connections.erase(fd);
+        close(fd);
+    }
+
+    // Sends as much pending output as the socket takes without blocking and arms EPOLLOUT
+    // for the rest. Returns false if the connection failed and was closed.
+    static bool flushPending(int epoll_fd, std::unordered_map<int, Connection>& connections, int fd) {
+        Connection& connection = connections.at(fd);
+        std::size_t sent = 0;
+
+        while (sent < connection.pending_.length()) {
+            ssize_t bytes = send(fd, connection.pending_.data() + sent, connection.pending_.length() - sent, MSG_NOSIGNAL);
+            if (bytes > 0) {
+                sent += bytes;
+            } else if (bytes < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                break;
+            } else {
+                closeConnection(epoll_fd, connections, fd);
+                return false;
+            }
+        }
+        connection.pending_.erase(0, sent);
+
+        if (connection.pending_.length() > MaxPendingBytes) {
+            std::cerr << "Dropping client that stopped reading responses" << std::endl;
+            closeConnection(epoll_fd, connections, fd);
+            return false;
+        }
+
+        bool waitingForWritable = !connection.pending_.empty();
+        if (waitingForWritable != connection.waitingForWritable_) {
+            epoll_event event{};
+            event.events = waitingForWritable ? EPOLLIN | EPOLLOUT : EPOLLIN;
+            event.data.fd = fd;
+            epoll_ctl(epoll_fd, EPOLL_CTL_MOD, fd, &event);
+            connection.waitingForWritable_ = waitingForWritable;
+        }
+        return true;
+    }
+
+    // Responses are tagged with the connection generation so that a reply for a closed
+    // socket is never delivered to a new connection that reused its descriptor.
+    void drainResponses(int epoll_fd, std::unordered_map<int, Connection>& connections) {
+        Response response;
+        while (responses_->tryPop(response)) {
+            auto it = connections.find(response.client_socket);
+            if (it == connections.end() || it->second.generation_ != response.generation) {
+                continue;
+            }
+
+            // Output already waiting goes first so responses stay in order; EPOLLOUT flushes it.
+            it->second.pending_.append(response.payload);
+            if (!it->second.waitingForWritable_) {
+                flushPending(epoll_fd, connections, response.client_socket);
+            }
+        }
+    }
+
+    void acceptClients(int epoll_fd, std::unordered_map<int, Connection>& connections, std::uint64_t& nextGeneration) {
+        while (true) {
+            int client_socket = accept4(server_fd_, nullptr, nullptr, SOCK_NONBLOCK);
+            if (client_socket < 0) {
+                return;
+            }
+
+            int opt = 1;
+            setsockopt(client_socket, IPPROTO_TCP, TCP_NODELAY, &opt, sizeof(opt));
+#ifdef SO_BUSY_POLL
+            int busyPollUs = 50;
+            setsockopt(client_socket, SOL_SOCKET, SO_BUSY_POLL, &busyPollUs, sizeof(busyPollUs));
+#endif
+
+            epoll_event event{};
+            event.events = EPOLLIN;
+            event.data.fd = client_socket;
+            epoll_ctl(epoll_fd, EPOLL_CTL_ADD, client_socket, &event);
+            connections[client_socket] = Connection{ nextGeneration++, { }, false };
+
+            std::cout << "Client connected" << std::endl;
+        }
+    }
+
+    void runNetworkLoop() {
+        if (config_.networkCpu >= 0 && !pinCurrentThread(config_.networkCpu)) {
+            std::cerr << "Failed to pin network thread to CPU " << config_.networkCpu << std::endl;
+        }
+
+        int epoll_fd = epoll_create1(0);
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = server_fd_;
+        epoll_ctl(epoll_fd, EPOLL_CTL_ADD, server_fd_, &event);
+
+        std::unordered_map<int, Connection> connections;
+        std::uint64_t nextGeneration = 1;
+        epoll_event events[64];
+        char buffer[4096];
+
+        while (running_.load(std::memory_order_relaxed)) {
+            // Zero timeout: spin on readiness instead of sleeping in the kernel.
+            int ready = epoll_wait(epoll_fd, events, 64, 0);
+
+            for (int i = 0; i < ready; ++i) {
+                int fd = events[i].data.fd;
+                if (fd == server_fd_) {
+                    acceptClients(epoll_fd, connections, nextGeneration);
+                    continue;
+                }
+
+                if (connections.find(fd) == connections.end()) {
+                    continue;
+                }
+
+                if ((events[i].events & EPOLLOUT) && !flushPending(epoll_fd, connections, fd)) {
+                    continue;
+                }
+
+                if (!(events[i].events & (EPOLLIN | EPOLLERR | EPOLLHUP))) {
+                    continue;
+                }
+
+                ssize_t bytes_read = recv(fd, buffer, sizeof(buffer) - 1, 0);
+                if (bytes_read < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                    continue;
+                }
+
+                if (bytes_read <= 0) {
+                    closeConnection(epoll_fd, connections, fd);
+                    continue;
+                }
+
+                Request request{ fd, connections.at(fd).generation_, Clock::now(), std::string(buffer, bytes_read) };
+                while (!requests_->tryPush(std::move(request))) {
+                    drainResponses(epoll_fd, connections);
+                    cpuRelax();
+                }
+            }
+
+            drainResponses(epoll_fd, connections);
+        }
+
+        for (auto& [fd, connection] : connections) {
+            close(fd);
+        }
+        close(epoll_fd);
+    }
+
 public:
-    OrderBookServer(int port = 9999) : port_(port) {}
+    explicit OrderBookServer(const ServerConfig& config) : config_(config) {}
 
     bool start() {
+        auto startupBegin = Clock::now();
+
         // Create socket
         server_fd_ = socket(AF_INET, SOCK_STREAM, 0);
         if (server_fd_ == -1) {
@@ -167,7 +625,7 @@ public:
         struct sockaddr_in address;
         address.sin_family = AF_INET;
         address.sin_addr.s_addr = INADDR_ANY;
-        address.sin_port = htons(port_);
+        address.sin_port = htons(config_.port);
 
         if (bind(server_fd_, (struct sockaddr*)&address, sizeof(address)) < 0) {
             std::cerr << "Bind failed" << std::endl;
@@ -180,7 +638,22 @@ public:
             return false;
         }
 
-        std::cout << "OrderBook TCP Server listening on port " << port_ << std::endl;
+        if (config_.lowLatency) {
+            prepareLowLatency();
+        }
+
+        auto startupMicros = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - startupBegin).count();
+        std::cout << "OrderBook TCP Server listening on port " << config_.port
+                  << " (" << (config_.lowLatency ? "low-latency" : "default") << " mode, startup "
+                  << startupMicros << "us)" << std::endl;
+
+        if (config_.lowLatency) {
+            fcntl(server_fd_, F_SETFL, fcntl(server_fd_, F_GETFL, 0) | O_NONBLOCK);
+            std::thread matching_thread(&OrderBookServer::runMatchingLoop, this);
+            runNetworkLoop();
+            matching_thread.join();
+            return true;
+        }
 
         // Accept connections
         while (true) {
@@ -204,14 +677,46 @@ public:
     }
 
     void stop() {
+        running_ = false;
         if (server_fd_ != -1) {
             close(server_fd_);
         }
     }
 };
 
-int main() {
-    OrderBookServer server(9999);
+static void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [--port N] [--low-latency] [--network-cpu N] [--matching-cpu N]"
+              << " [--prefault-orders N] [--prefault-levels N] [--report-interval SECONDS]" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    ServerConfig config;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--low-latency") {
+            config.lowLatency = true;
+        } else if (arg == "--port" && hasValue) {
+            config.port = std::stoi(argv[++i]);
+        } else if (arg == "--network-cpu" && hasValue) {
+            config.networkCpu = std::stoi(argv[++i]);
+        } else if (arg == "--matching-cpu" && hasValue) {
+            config.matchingCpu = std::stoi(argv[++i]);
+        } else if (arg == "--prefault-orders" && hasValue) {
+            config.prefaultOrders = std::stoul(argv[++i]);
+        } else if (arg == "--prefault-levels" && hasValue) {
+            config.prefaultLevels = std::stoul(argv[++i]);
+        } else if (arg == "--report-interval" && hasValue) {
+            config.reportIntervalSec = std::stoi(argv[++i]);
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    OrderBookServer server(config);
     
     if (!server.start()) {
         std::cerr << "Failed to start server" << std::endl;